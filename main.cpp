@@ -7,6 +7,8 @@
 #include <string>
 #include <algorithm>
 #include <iostream>
+#include <chrono>
+#include <cstdio>
 #include <Windows.h>
 #include <mmsystem.h>
 
@@ -14,6 +16,8 @@
 struct Config {
     static constexpr float windowWidth = 1000.0f;
     static constexpr float windowHeight = 800.0f;
+    static constexpr float worldWidth = 3000.0f; // Arena size; the window is a camera onto it
+    static constexpr float worldHeight = 2400.0f;
     static constexpr float buttonH = 30.0f;
     static constexpr float buttonW = 100.0f;
     static constexpr float playerSize = 20.0f; // Triangle bounding box
@@ -44,11 +48,22 @@ struct Config {
     static constexpr float speedBoostMultiplier = 1.5f; // Speed increase factor
     static constexpr float messageDisplayTime = 2.0f; // Message display duration
     static constexpr float wavePauseDuration = 2.0f; // Pause between waves
+    static constexpr float maxLatchTime = 0.05f; // Cap on late-latched player movement (seconds)
+    static constexpr float latencyReportInterval = 5.0f; // Seconds between latency reports
+    static constexpr float minZoom = 0.125f; // Furthest the camera can zoom out
+    static constexpr float maxZoom = 1.0f;
+    static constexpr float zoomStep = 1.25f; // Zoom factor per key press
+    static constexpr float gridCellSize = 100.0f; // Spatial grid cell size (world units)
+    static constexpr float lodPointSize = 3.0f; // Below this many pixels, shapes draw as points
+    static constexpr float lodQuadZoom = 0.5f; // Below this zoom, shapes draw as unrotated quads
+    static constexpr float starTileSize = 256.0f; // Starfield tile size (layer units)
+    static constexpr int starsPerTile = 6; // Stars per tile per layer at full zoom
+    static constexpr int starLayerCount = 3; // Parallax layers, far to near
 };
 
 // Game state
 struct GameState {
-    float playerX = Config::windowWidth / 2;
+    float playerX = Config::worldWidth / 2;
     float playerY = 50.0f;
     int health = Config::maxHealth;
     int score = 0;
@@ -88,12 +103,6 @@ struct Enemy {
 };
 std::vector<Enemy> enemies;
 
-// Star properties for space background
-struct Star {
-    float x, y;
-};
-std::vector<Star> stars;
-
 // Power-up types
 enum class PowerUpType {
     BULLET_INCREASER,
@@ -112,19 +121,91 @@ struct PowerUp {
 };
 std::vector<PowerUp> powerUps;
 
+// Camera onto the world; x, y is the bottom-left corner in world units
+struct Camera {
+    float x = 0.0f, y = 0.0f;
+    float zoom = 1.0f;
+};
+Camera camera;
+
+// Uniform grid of entity indices, rebuilt each tick for visibility queries
+struct SpatialGrid {
+    int cols = 0, rows = 0;
+    std::vector<std::vector<int>> cells;
+};
+SpatialGrid enemyGrid;
+SpatialGrid bulletGrid;
+SpatialGrid powerUpGrid;
+
+// Level of detail for entity shapes, chosen by on-screen size
+enum class Lod {
+    POINT,
+    QUAD,
+    FULL
+};
+
 // Movement state
-bool keyA, keyD, keyW, keyS;
-bool keyUp, keyDown, keyLeft, keyRight;
-float mouseX, mouseY;
+struct InputState {
+    bool keyA = false, keyD = false, keyW = false, keyS = false;
+    bool keyUp = false, keyDown = false, keyLeft = false, keyRight = false;
+    int cursorX = static_cast<int>(Config::windowWidth / 2); // Last cursor position in window coordinates
+    int cursorY = static_cast<int>(Config::windowHeight / 2);
+    float mouseX = 0.0f, mouseY = 0.0f; // Mouse-control target in world units
+};
+InputState input; // Applied by the simulation at tick boundaries
+InputState liveInput; // Freshest state as events arrive, used for late latching
+float lastTickTime = 0.0f; // Time of the last simulation tick
+
+// Input events, timestamped on arrival and drained at the start of each tick
+using InputClock = std::chrono::steady_clock;
+
+enum class InputEventType {
+    KEY_DOWN,
+    KEY_UP,
+    SPECIAL_DOWN,
+    SPECIAL_UP,
+    MOUSE_DOWN,
+    MOUSE_MOVE
+};
+
+struct InputEvent {
+    InputEventType type;
+    int key; // ASCII key, GLUT special key or mouse button
+    int x, y; // Window coordinates
+    float worldX, worldY; // World point under the cursor on arrival (MOUSE_MOVE only)
+    InputClock::time_point arrival;
+};
+std::vector<InputEvent> inputQueue;
+
+// Input-to-present latency tracking
+// Only the oldest unpresented arrival is kept, so each source yields at most one sample per present
+struct LatencyTracker {
+    const char* name;
+    bool hasPending = false;
+    InputClock::time_point oldestPending; // Oldest arrival waiting for the next present
+    std::vector<float> samples; // Latencies (ms) since the last report
+    std::string summary;
+};
+LatencyTracker keyLatency{"Keys"}; // Movement keys (late-latched)
+LatencyTracker mouseLatency{"Mouse"}; // Mouse steering (late-latched)
+LatencyTracker actionLatency{"Action"}; // Shots, toggles and clicks (applied on tick)
+float lastLatencyReportTime = 0.0f;
+bool showLatency = false;
+bool lateLatch = true; // Off presents only on ticks, as a baseline for the latency trackers
+bool latchRedrawPosted = false; // At most one late-latched redraw between ticks
 
 // Utility functions
-void drawTriangle(float x, float y, float size, float r, float g, float b) {
-    glColor3f(r, g, b);
+void emitTriangle(float x, float y, float size) {
     float halfSize = size / 2;
-    glBegin(GL_TRIANGLES);
     glVertex2f(x, y + halfSize); // Top
     glVertex2f(x - halfSize, y - halfSize); // Bottom-left
     glVertex2f(x + halfSize, y - halfSize); // Bottom-right
+}
+
+void drawTriangle(float x, float y, float size, float r, float g, float b) {
+    glColor3f(r, g, b);
+    glBegin(GL_TRIANGLES);
+    emitTriangle(x, y, size);
     glEnd();
 }
 
@@ -237,6 +318,50 @@ void drawHexagon(float x, float y, float size, float rotation, float r, float g,
     glPopMatrix();
 }
 
+// Full detail at zoom 1; zooming out collapses shapes to quads, then to points once they're tiny
+Lod lodFor(float size, float zoom) {
+    if (size * zoom < Config::lodPointSize) return Lod::POINT;
+    if (zoom < Config::lodQuadZoom) return Lod::QUAD;
+    return Lod::FULL;
+}
+
+GLenum lodPrimitive(Lod lod) {
+    return lod == Lod::POINT ? GL_POINTS : GL_QUADS;
+}
+
+// Emits a simplified shape inside an open glBegin(lodPrimitive(lod)) batch
+void emitLod(Lod lod, float x, float y, float size, float r, float g, float b) {
+    glColor3f(r, g, b);
+    if (lod == Lod::POINT) {
+        glVertex2f(x, y);
+        return;
+    }
+    float halfSize = size / 2;
+    glVertex2f(x - halfSize, y - halfSize);
+    glVertex2f(x + halfSize, y - halfSize);
+    glVertex2f(x + halfSize, y + halfSize);
+    glVertex2f(x - halfSize, y + halfSize);
+}
+
+using ShapeFn = void (*)(float x, float y, float size, float rotation, float r, float g, float b);
+
+struct PowerUpStyle {
+    ShapeFn shape;
+    float r, g, b;
+};
+
+PowerUpStyle powerUpStyle(PowerUpType type) {
+    switch (type) {
+        case PowerUpType::BULLET_INCREASER: return {drawSquare, 0.0f, 1.0f, 0.0f}; // Green
+        case PowerUpType::SPEED_BOOST: return {drawCircle, 0.0f, 0.0f, 1.0f}; // Blue
+        case PowerUpType::HEALTH_RESTORE: return {drawCross, 1.0f, 1.0f, 0.0f}; // Yellow
+        case PowerUpType::FASTER_SHOOTING: return {drawDiamond, 0.5f, 0.0f, 1.0f}; // Purple
+        case PowerUpType::INVINCIBILITY: return {drawStar, 1.0f, 1.0f, 1.0f}; // White
+        case PowerUpType::SCORE_MULTIPLIER: break;
+    }
+    return {drawHexagon, 1.0f, 0.5f, 0.0f}; // Orange
+}
+
 void drawButton(float x, float y, float w, float h, const std::string& label) {
     glColor3f(0.2f, 0.2f, 0.8f);
     glBegin(GL_QUADS);
@@ -260,19 +385,169 @@ void drawText(float x, float y, const std::string& text) {
     }
 }
 
-void initStars(int numStars) {
-    stars.clear();
-    for (int i = 0; i < numStars; ++i) {
-        stars.push_back({
-            static_cast<float>(rand() % static_cast<int>(Config::windowWidth)),
-            static_cast<float>(rand() % static_cast<int>(Config::windowHeight))
-        });
+float viewWidth(const Camera& view) {
+    return Config::windowWidth / view.zoom;
+}
+
+float viewHeight(const Camera& view) {
+    return Config::windowHeight / view.zoom;
+}
+
+// Centers one camera axis on a point, clamped to the world (or centered on it when zoomed past it)
+float followAxis(float focus, float view, float world) {
+    if (view >= world) return (world - view) / 2;
+    return std::max(0.0f, std::min(world - view, focus - view / 2));
+}
+
+Camera cameraFor(float focusX, float focusY, float zoom) {
+    Camera view;
+    view.zoom = zoom;
+    view.x = followAxis(focusX, viewWidth(view), Config::worldWidth);
+    view.y = followAxis(focusY, viewHeight(view), Config::worldHeight);
+    return view;
+}
+
+// Moves the simulation camera; rendering derives its own from the late-latched player
+void followCamera(float focusX, float focusY) {
+    camera = cameraFor(focusX, focusY, camera.zoom);
+}
+
+// World point under a window-space cursor position, as seen through a camera
+float cursorWorldX(const Camera& view, int x) {
+    return view.x + x / view.zoom;
+}
+
+float cursorWorldY(const Camera& view, int y) {
+    return view.y + (Config::windowHeight - y) / view.zoom;
+}
+
+// Deterministic per-tile seed so a tile regenerates the same stars every time it scrolls in
+unsigned int starTileSeed(int tileX, int tileY, int layer) {
+    unsigned int h = static_cast<unsigned int>(tileX) * 73856093u ^
+                     static_cast<unsigned int>(tileY) * 19349663u ^
+                     static_cast<unsigned int>(layer) * 83492791u;
+    return h ? h : 1u;
+}
+
+unsigned int nextStarRandom(unsigned int& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Procedural tiled starfield; each layer scrolls at a fraction of the camera for parallax
+void drawStarfield(const Camera& view) {
+    // Thin out tiles when zoomed out so on-screen star density stays roughly constant
+    int starsPerTile = std::max(1, static_cast<int>(Config::starsPerTile * view.zoom * view.zoom + 0.5f));
+    for (int layer = 0; layer < Config::starLayerCount; ++layer) {
+        float parallax = static_cast<float>(layer + 1) / (Config::starLayerCount + 1);
+        float brightness = 0.4f + 0.6f * layer / std::max(1, Config::starLayerCount - 1);
+        float offsetX = view.x * parallax;
+        float offsetY = view.y * parallax;
+        int firstTileX = static_cast<int>(std::floor(offsetX / Config::starTileSize));
+        int firstTileY = static_cast<int>(std::floor(offsetY / Config::starTileSize));
+        int lastTileX = static_cast<int>(std::floor((offsetX + viewWidth(view)) / Config::starTileSize));
+        int lastTileY = static_cast<int>(std::floor((offsetY + viewHeight(view)) / Config::starTileSize));
+
+        glPushMatrix();
+        glScalef(view.zoom, view.zoom, 1.0f);
+        glTranslatef(-offsetX, -offsetY, 0.0f);
+        glColor3f(brightness, brightness, brightness);
+        glBegin(GL_POINTS);
+        for (int ty = firstTileY; ty <= lastTileY; ++ty) {
+            for (int tx = firstTileX; tx <= lastTileX; ++tx) {
+                unsigned int state = starTileSeed(tx, ty, layer);
+                for (int i = 0; i < starsPerTile; ++i) {
+                    float sx = (nextStarRandom(state) % 1024) / 1024.0f;
+                    float sy = (nextStarRandom(state) % 1024) / 1024.0f;
+                    glVertex2f((tx + sx) * Config::starTileSize, (ty + sy) * Config::starTileSize);
+                }
+            }
+        }
+        glEnd();
+        glPopMatrix();
+    }
+}
+
+void initGrid(SpatialGrid& grid) {
+    grid.cols = static_cast<int>(std::ceil(Config::worldWidth / Config::gridCellSize));
+    grid.rows = static_cast<int>(std::ceil(Config::worldHeight / Config::gridCellSize));
+    grid.cells.assign(grid.cols * grid.rows, std::vector<int>());
+}
+
+void clearGrid(SpatialGrid& grid) {
+    for (auto& cell : grid.cells) {
+        cell.clear();
+    }
+}
+
+int gridColumn(const SpatialGrid& grid, float x) {
+    return std::max(0, std::min(grid.cols - 1, static_cast<int>(std::floor(x / Config::gridCellSize))));
+}
+
+int gridRow(const SpatialGrid& grid, float y) {
+    return std::max(0, std::min(grid.rows - 1, static_cast<int>(std::floor(y / Config::gridCellSize))));
+}
+
+void insertGrid(SpatialGrid& grid, float x, float y, int index) {
+    grid.cells[gridRow(grid, y) * grid.cols + gridColumn(grid, x)].push_back(index);
+}
+
+// Calls draw(item) for items whose center lies within margin of the camera view,
+// visiting only the grid cells the view overlaps
+template <typename T, typename Draw>
+void drawVisible(const Camera& view, const SpatialGrid& grid, const std::vector<T>& items, float margin, Draw draw) {
+    float minX = view.x - margin;
+    float minY = view.y - margin;
+    float maxX = view.x + viewWidth(view) + margin;
+    float maxY = view.y + viewHeight(view) + margin;
+    int firstCol = gridColumn(grid, minX);
+    int lastCol = gridColumn(grid, maxX);
+    int firstRow = gridRow(grid, minY);
+    int lastRow = gridRow(grid, maxY);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            for (int index : grid.cells[row * grid.cols + col]) {
+                const T& item = items[index];
+                if (item.x >= minX && item.x <= maxX && item.y >= minY && item.y <= maxY) {
+                    draw(item);
+                }
+            }
+        }
     }
 }
 
+void rebuildGrids() {
+    clearGrid(enemyGrid);
+    clearGrid(bulletGrid);
+    clearGrid(powerUpGrid);
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        insertGrid(enemyGrid, enemies[i].x, enemies[i].y, static_cast<int>(i));
+    }
+    for (size_t i = 0; i < bullets.size(); ++i) {
+        insertGrid(bulletGrid, bullets[i].x, bullets[i].y, static_cast<int>(i));
+    }
+    for (size_t i = 0; i < powerUps.size(); ++i) {
+        insertGrid(powerUpGrid, powerUps[i].x, powerUps[i].y, static_cast<int>(i));
+    }
+}
+
+// Entities enter just above the camera view, somewhere across its width, so each wave
+// falls through what the player can see
+float spawnX() {
+    float minX = std::max(10.0f, camera.x + 10.0f);
+    float maxX = std::min(Config::worldWidth - 10.0f, camera.x + viewWidth(camera) - 10.0f);
+    return minX + rand() % std::max(1, static_cast<int>(maxX - minX));
+}
+
+float spawnHeight(float size) {
+    return camera.y + viewHeight(camera) + size;
+}
+
 void spawnEnemy(float currentTime) {
     float speed = Config::enemyBaseSpeed + std::min(game.score * 5.0f + game.wave * 2.0f, 300.0f);
-    enemies.push_back({static_cast<float>(rand() % static_cast<int>(Config::windowWidth - 20) + 10), Config::windowHeight, speed, 0.0f});
+    enemies.push_back({spawnX(), spawnHeight(Config::enemySize), speed, 0.0f});
     game.lastSpawnTime = currentTime;
 }
 
@@ -285,7 +560,7 @@ void spawnPowerUp(float currentTime) {
     else if (randType == 3) type = PowerUpType::FASTER_SHOOTING;
     else if (randType == 4) type = PowerUpType::INVINCIBILITY;
     else type = PowerUpType::SCORE_MULTIPLIER;
-    powerUps.push_back({type, static_cast<float>(rand() % static_cast<int>(Config::windowWidth - 20) + 10), Config::windowHeight, 0.0f});
+    powerUps.push_back({type, spawnX(), spawnHeight(Config::powerUpSize), 0.0f});
     game.lastPowerUpSpawnTime = currentTime;
 }
 
@@ -294,6 +569,8 @@ void restartGame() {
     bullets.clear();
     enemies.clear();
     powerUps.clear();
+    rebuildGrids();
+    followCamera(game.playerX, game.playerY);
 }
 
 // AABB collision detection
@@ -304,33 +581,285 @@ bool checkCollision(float x1, float y1, float size1, float x2, float y2, float s
            y1 - half1 < y2 + half2 && y1 + half1 > y2 - half2;
 }
 
+void markPending(LatencyTracker& tracker, InputClock::time_point arrival) {
+    if (tracker.hasPending) return;
+    tracker.oldestPending = arrival;
+    tracker.hasPending = true;
+}
+
+// Turns the pending input arrival into a latency sample at present time
+void recordPresent(LatencyTracker& tracker, InputClock::time_point now) {
+    if (!tracker.hasPending) return;
+    tracker.samples.push_back(std::chrono::duration<float, std::milli>(now - tracker.oldestPending).count());
+    tracker.hasPending = false;
+}
+
+// Summarizes the latency distribution since the last report
+void reportLatency(LatencyTracker& tracker) {
+    if (tracker.samples.empty()) return;
+    std::sort(tracker.samples.begin(), tracker.samples.end());
+    auto percentile = [&tracker](float p) {
+        return tracker.samples[static_cast<size_t>(p * (tracker.samples.size() - 1))];
+    };
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s: p50 %.1fms p95 %.1fms p99 %.1fms max %.1fms (n=%d)",
+             tracker.name, percentile(0.5f), percentile(0.95f), percentile(0.99f),
+             tracker.samples.back(), static_cast<int>(tracker.samples.size()));
+    tracker.summary = buffer;
+    std::cout << "Input latency " << tracker.summary << std::endl;
+    tracker.samples.clear();
+}
+
+// Swaps buffers and attributes the present to every input it reflects
+void presentFrame() {
+    glutSwapBuffers();
+    // Wait for the GPU so the timestamp is when the frame was done, not when it was submitted
+    glFinish();
+    InputClock::time_point now = InputClock::now();
+    recordPresent(keyLatency, now);
+    recordPresent(mouseLatency, now);
+    recordPresent(actionLatency, now);
+
+    float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
+    if (currentTime - lastLatencyReportTime > Config::latencyReportInterval) {
+        reportLatency(keyLatency);
+        reportLatency(mouseLatency);
+        reportLatency(actionLatency);
+        lastLatencyReportTime = currentTime;
+    }
+}
+
+// Advances a player position by keyboard or mouse-driven movement
+void movePlayer(const InputState& in, float deltaTime, float& x, float& y) {
+    float effectiveSpeed = Config::playerSpeed * game.speedBoostMultiplier;
+    if (game.useMouseControl) {
+        float dx = in.mouseX - x;
+        float dy = in.mouseY - y;
+        float distance = sqrt(dx * dx + dy * dy);
+        if (distance > Config::playerMouseStopDist) {
+            float speed = effectiveSpeed * deltaTime;
+            float moveX = (dx / distance) * speed;
+            float moveY = (dy / distance) * speed;
+            x += moveX;
+            y += moveY;
+            x = std::max(Config::playerSize / 2, std::min(Config::worldWidth - Config::playerSize / 2, x));
+            y = std::max(Config::playerSize / 2, std::min(Config::worldHeight - Config::playerSize / 2, y));
+        }
+    } else {
+        if ((in.keyA || in.keyLeft) && x > Config::playerSize / 2) x -= effectiveSpeed * deltaTime;
+        if ((in.keyD || in.keyRight) && x < Config::worldWidth - Config::playerSize / 2) x += effectiveSpeed * deltaTime;
+        if ((in.keyW || in.keyUp) && y < Config::worldHeight - Config::playerSize / 2) y += effectiveSpeed * deltaTime;
+        if ((in.keyS || in.keyDown) && y > Config::playerSize / 2) y -= effectiveSpeed * deltaTime;
+    }
+}
+
+// Late-latches the player from the freshest input so the ship reflects
+// events that arrived since the last tick
+void latchPlayer(float& x, float& y) {
+    x = game.playerX;
+    y = game.playerY;
+    if (!lateLatch || game.gameOver || game.paused) return;
+    float latchTime = std::min(glutGet(GLUT_ELAPSED_TIME) / 1000.0f - lastTickTime, Config::maxLatchTime);
+    if (latchTime > 0.0f) {
+        movePlayer(liveInput, latchTime, x, y);
+    }
+}
+
+// The camera the player is looking at right now
+Camera seenCamera() {
+    float playerX, playerY;
+    latchPlayer(playerX, playerY);
+    return cameraFor(playerX, playerY, camera.zoom);
+}
+
+// Points the mouse-control target at the world point under the input's last cursor position
+void aimAtCursor(InputState& in) {
+    Camera view = seenCamera();
+    in.mouseX = cursorWorldX(view, in.cursorX);
+    in.mouseY = cursorWorldY(view, in.cursorY);
+}
+
+// Re-aims both input states after the cursor's world point changed under it (zoom, mode switch)
+void reaimCursor() {
+    aimAtCursor(input);
+    aimAtCursor(liveInput);
+}
+
+// Fires if the cooldown allows; returns true if a shot was fired
+bool shoot(float currentTime, LPCTSTR sound) {
+    float effectiveCooldown = (currentTime < game.fasterShootingEndTime) ? Config::fastBulletCooldown : Config::bulletCooldown;
+    if (currentTime - game.lastShotTime > effectiveCooldown) {
+        float startX = game.playerX - (game.bulletCount - 1) * Config::bulletOffset / 2;
+        for (int i = 0; i < game.bulletCount; ++i) {
+            bullets.push_back({startX + i * Config::bulletOffset, game.playerY + Config::playerSize / 2, Config::bulletSpeed});
+        }
+        game.lastShotTime = currentTime;
+        PlaySound(sound, NULL, SND_ASYNC | SND_FILENAME);
+        return true;
+    }
+    return false;
+}
+
+// Movement flag for a key, or nullptr if the key doesn't move the player
+bool* keyFlag(InputState& in, unsigned char key) {
+    if (key == 'a' || key == 'A') return &in.keyA;
+    if (key == 'd' || key == 'D') return &in.keyD;
+    if (key == 'w' || key == 'W') return &in.keyW;
+    if (key == 's' || key == 'S') return &in.keyS;
+    return nullptr;
+}
+
+bool* specialFlag(InputState& in, int key) {
+    if (key == GLUT_KEY_UP) return &in.keyUp;
+    if (key == GLUT_KEY_DOWN) return &in.keyDown;
+    if (key == GLUT_KEY_LEFT) return &in.keyLeft;
+    if (key == GLUT_KEY_RIGHT) return &in.keyRight;
+    return nullptr;
+}
+
+// Sets a movement flag; returns true if its state changed
+bool applyFlag(bool* flag, bool down) {
+    if (!flag || *flag == down) return false;
+    *flag = down;
+    return true;
+}
+
+// Zooms the simulation camera around the player (the camera isn't otherwise moved while paused)
+void setZoom(float zoom) {
+    camera.zoom = zoom;
+    followCamera(game.playerX, game.playerY);
+}
+
+// Applies a non-movement key; returns true if it changed anything visible
+bool handleKeyDown(unsigned char key, float currentTime) {
+    bool changed = true;
+    if (key == 'p' || key == 'P') game.paused = !game.paused;
+    else if (key == 'r' || key == 'R') restartGame();
+    else if (key == 'm' || key == 'M') {
+        game.useMouseControl = !game.useMouseControl;
+        if (game.useMouseControl) reaimCursor();
+    } else if (key == 'l' || key == 'L') showLatency = !showLatency;
+    else if (key == 't' || key == 'T') lateLatch = !lateLatch;
+    else if (key == '+' || key == '=') {
+        float zoom = std::min(Config::maxZoom, camera.zoom * Config::zoomStep);
+        changed = zoom != camera.zoom;
+        setZoom(zoom);
+    } else if (key == '-' || key == '_') {
+        float zoom = std::max(Config::minZoom, camera.zoom / Config::zoomStep);
+        changed = zoom != camera.zoom;
+        setZoom(zoom);
+    } else if (key == ' ' && !game.gameOver && !game.paused) {
+        changed = shoot(currentTime, TEXT("C:\\c++\\shooter\\sounds\\shoot.wav"));
+    } else {
+        changed = false;
+    }
+    return changed;
+}
+
+// Applies a click; returns true if it changed anything visible
+bool handleMouseDown(int button, int x, int y, float currentTime) {
+    int flippedY = Config::windowHeight - y;
+    bool changed = false;
+
+    if (!game.gameOver && !game.paused && button == GLUT_LEFT_BUTTON) {
+        changed = shoot(currentTime, TEXT("sounds/shoot.wav"));
+    }
+
+    if (!game.gameOver && x >= Config::windowWidth - 80 && x <= Config::windowWidth && flippedY >= Config::windowHeight - 40 && flippedY <= Config::windowHeight - 10) {
+        changed = changed || !game.paused;
+        game.paused = true;
+    }
+
+    if (game.paused && x >= 200 && x <= 300 && flippedY >= 220 && flippedY <= 250) {
+        game.paused = false;
+        changed = true;
+    }
+
+    if (game.gameOver && x >= Config::posX && x <= Config::posX + 100 && flippedY >= Config::posY && flippedY <= Config::posY + 40) {
+        restartGame();
+        changed = true;
+    }
+    return changed;
+}
+
+// Applies queued input to the simulation in arrival order; returns true if anything was applied
+bool processInput(float currentTime) {
+    if (inputQueue.empty()) return false;
+    float zoom = camera.zoom;
+    for (const auto& ev : inputQueue) {
+        switch (ev.type) {
+            case InputEventType::KEY_DOWN:
+                if (!applyFlag(keyFlag(input, static_cast<unsigned char>(ev.key)), true) &&
+                    handleKeyDown(static_cast<unsigned char>(ev.key), currentTime)) {
+                    markPending(actionLatency, ev.arrival);
+                }
+                break;
+            case InputEventType::KEY_UP:
+                applyFlag(keyFlag(input, static_cast<unsigned char>(ev.key)), false);
+                break;
+            case InputEventType::SPECIAL_DOWN:
+                applyFlag(specialFlag(input, ev.key), true);
+                break;
+            case InputEventType::SPECIAL_UP:
+                applyFlag(specialFlag(input, ev.key), false);
+                break;
+            case InputEventType::MOUSE_DOWN:
+                if (handleMouseDown(ev.key, ev.x, ev.y, currentTime)) markPending(actionLatency, ev.arrival);
+                break;
+            case InputEventType::MOUSE_MOVE:
+                input.cursorX = ev.x;
+                input.cursorY = ev.y;
+                input.mouseX = ev.worldX;
+                input.mouseY = ev.worldY;
+                break;
+        }
+    }
+    inputQueue.clear();
+    // Motion queued before the zoom applied was converted with the old zoom; keep the target under the cursor
+    if (camera.zoom != zoom) reaimCursor();
+    return true;
+}
+
 void display() {
     glClear(GL_COLOR_BUFFER_BIT);
 
+    float playerX, playerY;
+    latchPlayer(playerX, playerY);
+    Camera view = cameraFor(playerX, playerY, camera.zoom);
+
     // Draw stars
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_POINTS);
-    for (const auto& star : stars) {
-        glVertex2f(star.x, star.y);
-    }
-    glEnd();
+    drawStarfield(view);
 
     if (game.gameOver) {
         float posX = (Config::windowWidth / 2) - (Config::buttonW / 2);
         drawText(posX, Config::posY - 50, "Game Over!");
         drawText(posX, Config::posY, "Score: " + std::to_string(game.score));
         drawButton(posX, Config::posY + 20, Config::buttonW, Config::buttonH, "Restart");
-        glutSwapBuffers();
+        presentFrame();
         return;
     }
 
     if (game.paused) {
         drawText(200, 250, "Game Paused");
         drawButton(200, 220, 100, 30, "Resume");
-        glutSwapBuffers();
+        presentFrame();
         return;
     }
 
+    // World pass: everything below is in world units, seen through the camera
+    glPushMatrix();
+    glScalef(view.zoom, view.zoom, 1.0f);
+    glTranslatef(-view.x, -view.y, 0.0f);
+
+    // Draw world border
+    glColor3f(0.3f, 0.3f, 0.3f);
+    glBegin(GL_LINE_LOOP);
+    glVertex2f(0.0f, 0.0f);
+    glVertex2f(Config::worldWidth, 0.0f);
+    glVertex2f(Config::worldWidth, Config::worldHeight);
+    glVertex2f(0.0f, Config::worldHeight);
+    glEnd();
+
     // Draw player (flash if invincible)
     float healthRatio = static_cast<float>(game.health) / Config::maxHealth;
     float r = healthRatio;
@@ -338,42 +867,50 @@ void display() {
     if (glutGet(GLUT_ELAPSED_TIME) / 1000.0f < game.invincibilityEndTime) {
         r = g = (sin(glutGet(GLUT_ELAPSED_TIME) / 100.0f) + 1) / 2; // Flashing effect
     }
-    drawTriangle(game.playerX, game.playerY, Config::playerSize, r, g, 0.0f);
+    drawTriangle(playerX, playerY, Config::playerSize, r, g, 0.0f);
 
-    // Draw bullets
-    for (const auto& b : bullets) {
-        drawTriangle(b.x, b.y, Config::bulletSize, 1.0f, 1.0f, 0.0f);
-    }
+    // Draw bullets (a quad would cost more than the triangle, so they only collapse to points)
+    Lod bulletLod = lodFor(Config::bulletSize, view.zoom);
+    glColor3f(1.0f, 1.0f, 0.0f);
+    glBegin(bulletLod == Lod::POINT ? GL_POINTS : GL_TRIANGLES);
+    drawVisible(view, bulletGrid, bullets, Config::bulletSize, [bulletLod](const Bullet& b) {
+        if (bulletLod == Lod::POINT) glVertex2f(b.x, b.y);
+        else emitTriangle(b.x, b.y, Config::bulletSize);
+    });
+    glEnd();
 
     // Draw enemies
-    for (const auto& e : enemies) {
-        drawPentagon(e.x, e.y, Config::enemySize, e.rotation, 1.0f, 0.0f, 0.0f);
+    Lod enemyLod = lodFor(Config::enemySize, view.zoom);
+    if (enemyLod == Lod::FULL) {
+        drawVisible(view, enemyGrid, enemies, Config::enemySize, [](const Enemy& e) {
+            drawPentagon(e.x, e.y, Config::enemySize, e.rotation, 1.0f, 0.0f, 0.0f);
+        });
+    } else {
+        glBegin(lodPrimitive(enemyLod));
+        drawVisible(view, enemyGrid, enemies, Config::enemySize, [enemyLod](const Enemy& e) {
+            emitLod(enemyLod, e.x, e.y, Config::enemySize, 1.0f, 0.0f, 0.0f);
+        });
+        glEnd();
     }
 
     // Draw power-ups
-    for (const auto& pu : powerUps) {
-        switch (pu.type) {
-            case PowerUpType::BULLET_INCREASER:
-                drawSquare(pu.x, pu.y, Config::powerUpSize, pu.rotation, 0.0f, 1.0f, 0.0f); // Green
-                break;
-            case PowerUpType::SPEED_BOOST:
-                drawCircle(pu.x, pu.y, Config::powerUpSize, pu.rotation, 0.0f, 0.0f, 1.0f); // Blue
-                break;
-            case PowerUpType::HEALTH_RESTORE:
-                drawCross(pu.x, pu.y, Config::powerUpSize, pu.rotation, 1.0f, 1.0f, 0.0f); // Yellow
-                break;
-            case PowerUpType::FASTER_SHOOTING:
-                drawDiamond(pu.x, pu.y, Config::powerUpSize, pu.rotation, 0.5f, 0.0f, 1.0f); // Purple
-                break;
-            case PowerUpType::INVINCIBILITY:
-                drawStar(pu.x, pu.y, Config::powerUpSize, pu.rotation, 1.0f, 1.0f, 1.0f); // White
-                break;
-            case PowerUpType::SCORE_MULTIPLIER:
-                drawHexagon(pu.x, pu.y, Config::powerUpSize, pu.rotation, 1.0f, 0.5f, 0.0f); // Orange
-                break;
-        }
+    Lod powerUpLod = lodFor(Config::powerUpSize, view.zoom);
+    if (powerUpLod == Lod::FULL) {
+        drawVisible(view, powerUpGrid, powerUps, Config::powerUpSize, [](const PowerUp& pu) {
+            PowerUpStyle style = powerUpStyle(pu.type);
+            style.shape(pu.x, pu.y, Config::powerUpSize, pu.rotation, style.r, style.g, style.b);
+        });
+    } else {
+        glBegin(lodPrimitive(powerUpLod));
+        drawVisible(view, powerUpGrid, powerUps, Config::powerUpSize, [powerUpLod](const PowerUp& pu) {
+            PowerUpStyle style = powerUpStyle(pu.type);
+            emitLod(powerUpLod, pu.x, pu.y, Config::powerUpSize, style.r, style.g, style.b);
+        });
+        glEnd();
     }
 
+    glPopMatrix();
+
     // Draw UI
     drawText(10, Config::windowHeight - 30, "Score: " + std::to_string(game.score));
     drawText(10, Config::windowHeight - 50, "Health: " + std::to_string(game.health));
@@ -390,20 +927,32 @@ void display() {
     if (game.messageEndTime > glutGet(GLUT_ELAPSED_TIME) / 1000.0f) {
         drawText(10, Config::windowHeight - 190, game.message);
     }
+    if (showLatency) {
+        drawText(10, 70, std::string("Late latch (T): ") + (lateLatch ? "on" : "off"));
+        drawText(10, 50, keyLatency.summary.empty() ? "Keys: collecting..." : keyLatency.summary);
+        drawText(10, 30, mouseLatency.summary.empty() ? "Mouse: collecting..." : mouseLatency.summary);
+        drawText(10, 10, actionLatency.summary.empty() ? "Action: collecting..." : actionLatency.summary);
+    }
 
     // Pause button
     drawButton(Config::windowWidth - 80, Config::windowHeight - 40, 80, 30, "Pause");
 
-    glutSwapBuffers();
+    presentFrame();
 }
 
 void update(int value) {
-    static float lastTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
     float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
-    float deltaTime = currentTime - lastTime;
-    lastTime = currentTime;
+    float deltaTime = currentTime - lastTickTime;
+    lastTickTime = currentTime;
+    latchRedrawPosted = false;
+
+    bool inputApplied = processInput(currentTime);
 
     if (game.gameOver || game.paused) {
+        // Nothing moves while stopped, so don't let idle time count as movement latency
+        keyLatency.hasPending = false;
+        mouseLatency.hasPending = false;
+        if (inputApplied) glutPostRedisplay();
         glutTimerFunc(16, update, 0);
         return;
     }
@@ -423,33 +972,16 @@ void update(int value) {
     }
 
     // Player movement
-    float effectiveSpeed = Config::playerSpeed * game.speedBoostMultiplier;
-    if (game.useMouseControl) {
-        float dx = mouseX - game.playerX;
-        float dy = mouseY - game.playerY;
-        float distance = sqrt(dx * dx + dy * dy);
-        if (distance > Config::playerMouseStopDist) {
-            float speed = effectiveSpeed * deltaTime;
-            float moveX = (dx / distance) * speed;
-            float moveY = (dy / distance) * speed;
-            game.playerX += moveX;
-            game.playerY += moveY;
-            game.playerX = std::max(Config::playerSize / 2, std::min(Config::windowWidth - Config::playerSize / 2, game.playerX));
-            game.playerY = std::max(Config::playerSize / 2, std::min(Config::windowHeight - Config::playerSize / 2, game.playerY));
-        }
-    } else {
-        if ((keyA || keyLeft) && game.playerX > Config::playerSize / 2) game.playerX -= effectiveSpeed * deltaTime;
-        if ((keyD || keyRight) && game.playerX < Config::windowWidth - Config::playerSize / 2) game.playerX += effectiveSpeed * deltaTime;
-        if ((keyW || keyUp) && game.playerY < Config::windowHeight - Config::playerSize / 2) game.playerY += effectiveSpeed * deltaTime;
-        if ((keyS || keyDown) && game.playerY > Config::playerSize / 2) game.playerY -= effectiveSpeed * deltaTime;
-    }
+    movePlayer(input, deltaTime, game.playerX, game.playerY);
+    followCamera(game.playerX, game.playerY);
 
     // Update bullets
     for (auto& b : bullets) {
         b.y += b.dy * deltaTime;
     }
-    bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](const Bullet& b) {
-        return b.y > Config::windowHeight;
+    float viewTop = camera.y + viewHeight(camera);
+    bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [viewTop](const Bullet& b) {
+        return b.y > viewTop + Config::bulletSize;
     }), bullets.end());
 
     // Update enemies
@@ -575,97 +1107,81 @@ void update(int value) {
         }
     }
 
-    // Remove off-screen enemies
+    // Remove enemies that fell below the view
     enemies.erase(std::remove_if(enemies.begin(), enemies.end(), [](const Enemy& e) {
-        return e.y < 0;
+        return e.y < camera.y - Config::enemySize;
     }), enemies.end());
 
-    // Remove off-screen power-ups
+    // Remove power-ups that fell below the view
     powerUps.erase(std::remove_if(powerUps.begin(), powerUps.end(), [](const PowerUp& pu) {
-        return pu.y < 0;
+        return pu.y < camera.y - Config::powerUpSize;
     }), powerUps.end());
 
+    rebuildGrids();
+
     glutPostRedisplay();
     glutTimerFunc(16, update, 0);
 }
 
-void keyboardDown(unsigned char key, int x, int y) {
-    if (key == 'a' || key == 'A') keyA = true;
-    if (key == 'd' || key == 'D') keyD = true;
-    if (key == 'w' || key == 'W') keyW = true;
-    if (key == 's' || key == 'S') keyS = true;
-    if (key == 'p' || key == 'P') game.paused = !game.paused;
-    if (key == 'r' || key == 'R') restartGame();
-    if (key == 'm' || key == 'M') game.useMouseControl = !game.useMouseControl;
-    if (key == ' ') {
-        float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
-        float effectiveCooldown = (currentTime < game.fasterShootingEndTime) ? Config::fastBulletCooldown : Config::bulletCooldown;
-        if (currentTime - game.lastShotTime > effectiveCooldown) {
-            float startX = game.playerX - (game.bulletCount - 1) * Config::bulletOffset / 2;
-            for (int i = 0; i < game.bulletCount; ++i) {
-                bullets.push_back({startX + i * Config::bulletOffset, game.playerY + Config::playerSize / 2, Config::bulletSpeed});
-            }
-            game.lastShotTime = currentTime;
-            PlaySound(TEXT("C:\\c++\\shooter\\sounds\\shoot.wav"), NULL, SND_ASYNC | SND_FILENAME);
-        }
+void queueInput(InputEventType type, int key, int x, int y) {
+    inputQueue.push_back({type, key, x, y, 0.0f, 0.0f, InputClock::now()});
+}
+
+bool isRunning() {
+    return !game.gameOver && !game.paused;
+}
+
+// Presents one frame ahead of the next tick so display() can late-latch a movement change
+void latchMovement(LatencyTracker& tracker) {
+    if (!isRunning()) return;
+    markPending(tracker, inputQueue.back().arrival);
+    if (lateLatch && !latchRedrawPosted) {
+        latchRedrawPosted = true;
+        glutPostRedisplay();
     }
 }
 
+void keyboardDown(unsigned char key, int x, int y) {
+    queueInput(InputEventType::KEY_DOWN, key, x, y);
+    // Auto-repeat doesn't change held keys, so only fresh presses are latched
+    if (applyFlag(keyFlag(liveInput, key), true)) latchMovement(keyLatency);
+}
+
 void keyboardUp(unsigned char key, int x, int y) {
-    if (key == 'a' || key == 'A') keyA = false;
-    if (key == 'd' || key == 'D') keyD = false;
-    if (key == 'w' || key == 'W') keyW = false;
-    if (key == 's' || key == 'S') keyS = false;
+    queueInput(InputEventType::KEY_UP, key, x, y);
+    if (applyFlag(keyFlag(liveInput, key), false)) latchMovement(keyLatency);
 }
 
 void specialDown(int key, int x, int y) {
-    if (key == GLUT_KEY_UP) keyUp = true;
-    if (key == GLUT_KEY_DOWN) keyDown = true;
-    if (key == GLUT_KEY_LEFT) keyLeft = true;
-    if (key == GLUT_KEY_RIGHT) keyRight = true;
+    queueInput(InputEventType::SPECIAL_DOWN, key, x, y);
+    if (applyFlag(specialFlag(liveInput, key), true)) latchMovement(keyLatency);
 }
 
 void specialUp(int key, int x, int y) {
-    if (key == GLUT_KEY_UP) keyUp = false;
-    if (key == GLUT_KEY_DOWN) keyDown = false;
-    if (key == GLUT_KEY_LEFT) keyLeft = false;
-    if (key == GLUT_KEY_RIGHT) keyRight = false;
+    queueInput(InputEventType::SPECIAL_UP, key, x, y);
+    if (applyFlag(specialFlag(liveInput, key), false)) latchMovement(keyLatency);
 }
 
 void mouse(int button, int state, int x, int y) {
     if (state != GLUT_DOWN) return;
-
-    float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
-    int flippedY = Config::windowHeight - y;
-
-    if (!game.gameOver && !game.paused && button == GLUT_LEFT_BUTTON) {
-        float effectiveCooldown = (currentTime < game.fasterShootingEndTime) ? Config::fastBulletCooldown : Config::bulletCooldown;
-        if (currentTime - game.lastShotTime > effectiveCooldown) {
-            float startX = game.playerX - (game.bulletCount - 1) * Config::bulletOffset / 2;
-            for (int i = 0; i < game.bulletCount; ++i) {
-                bullets.push_back({startX + i * Config::bulletOffset, game.playerY + Config::playerSize / 2, Config::bulletSpeed});
-            }
-            game.lastShotTime = currentTime;
-            PlaySound(TEXT("sounds/shoot.wav"), NULL, SND_ASYNC | SND_FILENAME);
-        }
-    }
-
-    if (!game.gameOver && x >= Config::windowWidth - 80 && x <= Config::windowWidth && flippedY >= Config::windowHeight - 40 && flippedY <= Config::windowHeight - 10) {
-        game.paused = true;
-    }
-
-    if (game.paused && x >= 200 && x <= 300 && flippedY >= 220 && flippedY <= 250) {
-        game.paused = false;
-    }
-
-    if (game.gameOver && x >= Config::posX && x <= Config::posX + 100 && flippedY >= Config::posY && flippedY <= Config::posY + 40) {
-        restartGame();
-    }
+    queueInput(InputEventType::MOUSE_DOWN, button, x, y);
 }
 
 void passiveMotion(int x, int y) {
-    mouseX = static_cast<float>(x);
-    mouseY = Config::windowHeight - static_cast<float>(y);
+    // Coalesce motion between ticks; only the latest position matters to the simulation
+    if (inputQueue.empty() || inputQueue.back().type != InputEventType::MOUSE_MOVE) {
+        queueInput(InputEventType::MOUSE_MOVE, 0, x, y);
+    }
+    // Latch the world point under the cursor now, so the target stays put as the camera follows the ship
+    liveInput.cursorX = x;
+    liveInput.cursorY = y;
+    aimAtCursor(liveInput);
+    InputEvent& ev = inputQueue.back();
+    ev.x = x;
+    ev.y = y;
+    ev.worldX = liveInput.mouseX;
+    ev.worldY = liveInput.mouseY;
+    if (game.useMouseControl) latchMovement(mouseLatency);
 }
 
 void init() {
@@ -674,7 +1190,12 @@ void init() {
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
     gluOrtho2D(0, Config::windowWidth, 0, Config::windowHeight);
-    initStars(200);
+    initGrid(enemyGrid);
+    initGrid(bulletGrid);
+    initGrid(powerUpGrid);
+    followCamera(game.playerX, game.playerY);
+    lastTickTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
+    lastLatencyReportTime = lastTickTime;
 }
 
 int main(int argc, char** argv) {